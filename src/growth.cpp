@@ -0,0 +1,152 @@
+#include "growth.h"
+#include "params.h"
+#include "simulation.h"
+#include <climits>
+#include <exception>
+#include <stdexcept>
+#include <string>
+
+// One embedded simulation, owns its parameters (no use of the global params)
+struct growth_sim {
+	explicit growth_sim(const growth_params& p) : params(p), sim(params) {}
+
+	parameters params;
+	simulation sim;
+	bool finished = false;
+};
+
+namespace {
+
+thread_local std::string lasterror;
+
+// Run f, turning exceptions into growth_lasterror() and a return value of fail
+// (success leaves the last error untouched)
+template <typename F>
+auto guarded_(F f, decltype(f()) fail) -> decltype(f()) {
+	try {
+		return f();
+	} catch (const std::exception& e) {
+		lasterror = e.what();
+	} catch (...) {
+		lasterror = "unknown error";
+	}
+	return fail;
+}
+
+// parameters divides and allocates with these before it can check anything itself
+void validate_(const growth_params& p) {
+	if (p.size != sizeof(growth_params)) {
+		throw std::invalid_argument(
+			"growth_create: p->size does not match this library's growth_params (start from growth_defaultparams())");
+	}
+	if (p.windowwidth <= 0 || p.windowheight <= 0) {
+		throw std::invalid_argument("growth_create: windowwidth and windowheight must be > 0");
+	}
+	if (p.pixelsize <= 0) {
+		throw std::invalid_argument("growth_create: pixelsize must be > 0");
+	}
+	if (p.windowwidth % p.pixelsize != 0 || p.windowheight % p.pixelsize != 0) {
+		throw std::invalid_argument("growth_create: pixelsize must divide windowwidth and windowheight");
+	}
+	if (p.celldeterrad < 2) {
+		throw std::invalid_argument("growth_create: celldeterrad must be >= 2");
+	}
+	if (p.cellattractrad < 0 || p.cellattractrad > p.celldeterrad) {
+		throw std::invalid_argument("growth_create: cellattractrad must be in [0, celldeterrad]");
+	}
+	if (p.numinitcells < 0) {
+		throw std::invalid_argument("growth_create: numinitcells must be >= 0");
+	}
+	// edgebufArr sizes and indexes in int, incl. the buffer of celldeterrad around the grid
+	long long bufx = p.windowwidth / p.pixelsize + 2LL * p.celldeterrad;
+	long long bufy = p.windowheight / p.pixelsize + 2LL * p.celldeterrad;
+	if (bufx > INT_MAX || bufy > INT_MAX || bufx * bufy > INT_MAX) { // (each <= INT_MAX: product fits)
+		throw std::invalid_argument("growth_create: grid (incl. celldeterrad buffer) has more than INT_MAX pixels");
+	}
+}
+
+template <typename T, typename V>
+void fillview_(const edgebufArr<T>& arr, V* view) {
+	view->data = arr.data();
+	view->sizex = arr.sizex();
+	view->sizey = arr.sizey();
+	view->stride = arr.stride();
+}
+
+} // namespace
+
+//--------------------------------------------------------------
+int growth_defaultparams(growth_params* p) {
+	return guarded_([p]() {
+		if (!p) throw std::invalid_argument("growth_defaultparams: p is NULL");
+		*p = parameters::defaultsettings();
+		return 0;
+	}, -1);
+}
+
+//--------------------------------------------------------------
+growth_sim* growth_create(const growth_params* p) {
+	return guarded_([p]() -> growth_sim* {
+		if (!p) throw std::invalid_argument("growth_create: p is NULL");
+		validate_(*p);
+		return new growth_sim(*p);
+	}, nullptr);
+}
+
+//--------------------------------------------------------------
+void growth_destroy(growth_sim* sim) {
+	delete sim;
+}
+
+//--------------------------------------------------------------
+int growth_step(growth_sim* sim, int n) {
+	return guarded_([sim, n]() {
+		if (!sim) throw std::invalid_argument("growth_step: sim is NULL");
+		int done = 0;
+		while (done < n && !sim->finished) {
+			if (sim->sim.step()) {
+				done++;
+			} else {
+				sim->finished = true;
+			}
+		}
+		return done;
+	}, -1);
+}
+
+//--------------------------------------------------------------
+int growth_stats_get(const growth_sim* sim, growth_stats* stats) {
+	return guarded_([sim, stats]() {
+		if (!sim || !stats) throw std::invalid_argument("growth_stats_get: sim or stats is NULL");
+		stats->step = sim->sim.stepcount();
+		stats->activecells = sim->sim.activecount();
+		stats->totalcells = sim->sim.totalcount();
+		stats->spawned = sim->sim.lastspawned();
+		stats->culled = sim->sim.lastculled();
+		stats->finished = sim->finished ? 1 : 0;
+		return 0;
+	}, -1);
+}
+
+//--------------------------------------------------------------
+int growth_potentialmap(const growth_sim* sim, growth_floatview* view) {
+	return guarded_([sim, view]() {
+		if (!sim || !view) throw std::invalid_argument("growth_potentialmap: sim or view is NULL");
+		fillview_(sim->params.potentialmap, view);
+		return 0;
+	}, -1);
+}
+
+//--------------------------------------------------------------
+int growth_occupancy(const growth_sim* sim, growth_byteview* view) {
+	return guarded_([sim, view]() {
+		if (!sim || !view) throw std::invalid_argument("growth_occupancy: sim or view is NULL");
+		fillview_(sim->params.occupancy, view);
+		return 0;
+	}, -1);
+}
+
+//--------------------------------------------------------------
+const char* growth_lasterror(void) {
+	return lasterror.c_str();
+}
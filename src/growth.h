@@ -0,0 +1,100 @@
+#ifndef GROWTH_H
+#define GROWTH_H
+
+/*
+ * C API of the headless Growth library (libgrowth, see Makefile / Growth.qbs).
+ * Every growth_sim is independent (own parameters, potential map, rng), so any number of them
+ * can live in one process and different simulations may be stepped from different threads.
+ * A single simulation must not be used from several threads at once.
+ * Functions never throw: failures return NULL / -1 and growth_lasterror() tells why.
+ */
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(_WIN32)
+	#ifdef GROWTH_BUILD_LIB
+		#define GROWTH_API __declspec(dllexport)
+	#else
+		#define GROWTH_API __declspec(dllimport)
+	#endif
+#else
+	#define GROWTH_API __attribute__((visibility("default")))
+#endif
+
+// Settable run-time parameters, same meaning as in params.h:parameters
+// (without stride, the app's steps per frame). Always start from growth_defaultparams():
+// it sets size, which growth_create() checks so hosts built against another layout are rejected.
+typedef struct growth_params {
+	uint32_t size;	// sizeof(growth_params)
+	int windowwidth;
+	int windowheight;
+	int pixelsize;
+	int numinitcells;
+	int celldeterrad;
+	int cellattractrad;
+	int celldeterage;
+	float celldeterfactor;
+	float cellattractfactor;
+	unsigned seed;
+} growth_params;
+
+typedef struct growth_stats {
+	uint64_t step;			// steps done so far
+	uint64_t activecells;	// Cells that can still multiply
+	uint64_t totalcells;	// Cells spawned so far (incl. initial ones, several can share a Pixel)
+	uint64_t spawned;		// Cells spawned in last step
+	uint64_t culled;		// Cells removed from active ones in last step
+	int finished;				// 1 if no Cell can multiply anymore, stepping does nothing then
+} growth_stats;
+
+// Read-only view of a grid [0, sizex) x [0, sizey), element (i, j) is data[i*stride + j].
+// Points directly into the simulation: valid until growth_destroy(), changes with every step.
+typedef struct growth_floatview {
+	const float* data;
+	int sizex;
+	int sizey;
+	int stride;
+} growth_floatview;
+
+typedef struct growth_byteview {
+	const unsigned char* data;
+	int sizex;
+	int sizey;
+	int stride;
+} growth_byteview;
+
+typedef struct growth_sim growth_sim;
+
+// Fill p with the defaults from params.h (seed is random), 0 on success, -1 on error
+GROWTH_API int growth_defaultparams(growth_params* p);
+
+// Set up a simulation incl. its initial Cells, NULL on invalid parameters (see growth_lasterror())
+GROWTH_API growth_sim* growth_create(const growth_params* p);
+
+GROWTH_API void growth_destroy(growth_sim* sim);
+
+// Do up to n steps, returns the number done (less than n once finished), -1 on error
+GROWTH_API int growth_step(growth_sim* sim, int n);
+
+GROWTH_API int growth_stats_get(const growth_sim* sim, growth_stats* stats);
+
+// Potential on the grid (0 where a Cell sits or potential vanished)
+GROWTH_API int growth_potentialmap(const growth_sim* sim, growth_floatview* view);
+
+// 1 where a Cell sits, else 0
+GROWTH_API int growth_occupancy(const growth_sim* sim, growth_byteview* view);
+
+// Message of the last failure on this thread, empty string if none yet.
+// Not reset by successful calls: only check it after a call returned NULL / -1.
+// The pointer stays valid until the next failing call on this thread.
+GROWTH_API const char* growth_lasterror(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // GROWTH_H
@@ -0,0 +1,110 @@
+#include "instrument.h"
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+
+// define global instrumentation (see instrument.h),
+// only written to by the GROWTH_* macros
+instrumentation instr;
+
+//--------------------------------------------------------------
+void instrumentation::sample(float sumpot) {
+	if (!(sumpot > 0.f)) {
+		hist_[0]++;
+		return;
+	}
+	// sumpot = m * 2^e with m in [0.5, 1), i.e. bin b holds [2^(e-1), 2^e)
+	// bin 1 and numbins-1 catch everything below/above
+	int e;
+	std::frexp(sumpot, &e);
+	int b = e + numbins / 2;
+	if (b < 1) b = 1;
+	if (b > numbins - 1) b = numbins - 1;
+	hist_[b]++;
+}
+
+//--------------------------------------------------------------
+bool instrumentation::exportall(const std::string& tracepath,
+								const std::string& csvpath,
+								const std::string& histpath) const {
+	// Chrome trace: complete events for traced scopes, counter events per step
+	// fixed precision: default 6 significant digits only resolve 10 us after 1 s
+	std::ofstream trace(tracepath);
+	trace << std::fixed << std::setprecision(3);
+	trace << "{\"traceEvents\":[\n";
+	bool first = true;
+	for (const auto& ev : events_) {
+		trace << (first ? "" : ",\n")
+			  << "{\"name\":\"" << name(ev.p) << "\",\"ph\":\"X\",\"pid\":1,\"tid\":1"
+			  << ",\"ts\":" << us_(ev.start)
+			  << ",\"dur\":" << std::chrono::duration<double, std::micro>(ev.dur).count() << "}";
+		first = false;
+	}
+	for (const auto& st : steps_) {
+		trace << (first ? "" : ",\n")
+			  << "{\"name\":\"counters\",\"ph\":\"C\",\"pid\":1,\"ts\":" << us_(st.start) << ",\"args\":{";
+		for (int c = 0; c < numcounters; c++) {
+			trace << (c ? "," : "") << "\"" << name(static_cast<counter>(c)) << "\":" << st.counters[c];
+		}
+		trace << "}}";
+		first = false;
+	}
+	trace << "\n],\"otherData\":{\"droppedevents\":" << droppedevents_ << "}}\n";
+
+	// one row per step, phase times in microseconds (sampled phases empty outside of sampled steps)
+	std::ofstream csv(csvpath);
+	csv << std::fixed << std::setprecision(3);
+	csv << "step";
+	for (int c = 0; c < numcounters; c++) csv << "," << name(static_cast<counter>(c));
+	for (int p = 0; p < numphases; p++) csv << "," << name(static_cast<phase>(p)) << "_us";
+	csv << "\n";
+	for (std::size_t s = 0; s < steps_.size(); s++) {
+		csv << s;
+		for (auto n : steps_[s].counters) csv << "," << n;
+		for (int p = 0; p < numphases; p++) {
+			csv << ",";
+			if (steps_[s].sampled || !sampled(static_cast<phase>(p))) {
+				csv << std::chrono::duration<double, std::micro>(steps_[s].times[p]).count();
+			}
+		}
+		csv << "\n";
+	}
+
+	std::ofstream hist(histpath);
+	hist << "lower,upper,count\n";
+	hist << "0,0," << hist_[0] << "\n";
+	for (int b = 1; b < numbins; b++) {
+		double lower = (b == 1) ? 0. : std::ldexp(1., b - numbins / 2 - 1);
+		double upper = (b == numbins - 1) ? std::numeric_limits<double>::infinity()
+										  : std::ldexp(1., b - numbins / 2);
+		hist << lower << "," << upper << "," << hist_[b] << "\n";
+	}
+
+	return trace.good() && csv.good() && hist.good();
+}
+
+//--------------------------------------------------------------
+const char* instrumentation::name(phase p) {
+	switch (p) {
+		case phase::survey: return "survey";
+		case phase::culling: return "culling";
+		case phase::selection: return "selection";
+		case phase::multiply: return "multiply";
+		case phase::stamps: return "stamps";
+		case phase::draw: return "draw";
+		default: return "unknown";
+	}
+}
+
+//--------------------------------------------------------------
+const char* instrumentation::name(counter c) {
+	switch (c) {
+		case counter::activecells: return "activecells";
+		case counter::spawns: return "spawns";
+		case counter::deters: return "deters";
+		case counter::culled: return "culled";
+		case counter::stamppixels: return "stamppixels";
+		default: return "unknown";
+	}
+}
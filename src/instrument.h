@@ -0,0 +1,205 @@
+#pragma once
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/*
+ * Low-overhead instrumentation of the simulation hot paths.
+ * Only the GROWTH_* macros at the bottom of this file should be used in simulation code:
+ * they compile to nothing unless GROWTH_INSTRUMENT is defined (see config.make and Growth.qbs).
+ * All data is kept in memory by the global object instr and only written on exportall():
+ *  - Chrome trace JSON (open in chrome://tracing or ui.perfetto.dev)
+ *  - CSV with one row per step (counters and accumulated phase times)
+ *  - CSV histogram of Cell::sumpot_ over the whole run
+ */
+
+// Timed phases. survey and stamps happen inside culling/multiply so phase times do not add up to the step time.
+// draw covers ofApp drawing newly spawned Cells into the fbo and the fbo to the window (outside of steps).
+// survey and stamps run per Cell, timing them costs about as much as the work itself: they are only timed
+// (every run) in one step out of samplesteps and left empty in the CSV rows of all other steps (see GROWTH_SAMPLE).
+// In sampled steps culling and multiply include that timer overhead.
+enum class phase : int {
+	survey,		// Cell gathering neighbor potential and summing it up
+	culling,	// removal of Cells that cannot multiply
+	selection,	// sorting Cells by sumpot_
+	multiply,	// spawning new Cells
+	stamps,		// Cells factoring potential around them (attract, deter)
+	draw,		// drawing to and from the fbo
+	count
+};
+
+enum class counter : int {
+	activecells,	// active Cells at the start of a step
+	spawns,			// Cells spawned
+	deters,			// Cells that reached celldeterage and deterred their surroundings
+	culled,			// dead Cells removed from activecells_
+	stamppixels,	// Pixels of potentialmap touched by stamps
+	count
+};
+
+class instrumentation {
+
+	using clock = std::chrono::steady_clock;
+
+	public:
+		static constexpr int numphases = static_cast<int>(phase::count);
+		static constexpr int numcounters = static_cast<int>(counter::count);
+		static constexpr int numbins = 64; // bin 0: sumpot <= 0, others: powers of 2 (see sample())
+		static constexpr std::size_t maxevents = 1 << 20; // trace events kept, later ones are only counted
+		static constexpr std::size_t samplesteps = 16; // sampled phases are timed in one in samplesteps steps
+
+		// Row 0 of the step table collects everything recorded before the first step (i.e. setup)
+		instrumentation() : t0_(clock::now()), steps_(1) {
+			steps_[0].start = t0_;
+			steps_[0].sampled = true;
+		}
+
+		// Open a new row in the step table, call once at the start of every step
+		void beginstep() {
+			steps_.emplace_back();
+			steps_.back().start = clock::now();
+			steps_.back().sampled = (steps_.size() - 1) % samplesteps == 0;
+		}
+
+		// Whether sampled phases are timed in the current step
+		bool samplingstep() const {
+			return steps_.back().sampled;
+		}
+
+		// Phases only timed in sampled steps (see GROWTH_SAMPLE)
+		static bool sampled(phase p) {
+			return p == phase::survey || p == phase::stamps;
+		}
+
+		void add(counter c, long n) {
+			steps_.back().counters[static_cast<int>(c)] += n;
+		}
+
+		void set(counter c, long n) {
+			steps_.back().counters[static_cast<int>(c)] = n;
+		}
+
+		// Accumulate time spent in p during current step
+		void addtime(phase p, clock::duration d) {
+			steps_.back().times[static_cast<int>(p)] += d;
+		}
+
+		// Additionally keep a trace event, only use for scopes that are not run per Cell
+		void addtrace(phase p, clock::time_point start, clock::duration d) {
+			if (events_.size() < maxevents) {
+				events_.push_back({p, start, d});
+			} else {
+				droppedevents_++;
+			}
+		}
+
+		// Add a value of Cell::sumpot_ to the histogram
+		void sample(float sumpot);
+
+		// Write all recorded data, returns false if any file could not be written
+		bool exportall(const std::string& tracepath,
+					   const std::string& csvpath,
+					   const std::string& histpath) const;
+
+		static const char* name(phase p);
+		static const char* name(counter c);
+
+		// Times a scope and records it on destruction
+		class scopedtimer {
+			public:
+				scopedtimer(instrumentation& in, phase p, bool trace) : in_(in),
+																		p_(p),
+																		trace_(trace),
+																		start_(clock::now()) {}
+				~scopedtimer() {
+					clock::duration d = clock::now() - start_;
+					in_.addtime(p_, d);
+					if (trace_) in_.addtrace(p_, start_, d);
+				}
+
+				scopedtimer(const scopedtimer&) = delete;
+				scopedtimer& operator=(const scopedtimer&) = delete;
+
+			private:
+				instrumentation& in_;
+				const phase p_;
+				const bool trace_;
+				const clock::time_point start_;
+		};
+
+		// Times a scope only during sampled steps (see samplingstep())
+		class sampledtimer {
+			public:
+				sampledtimer(instrumentation& in, phase p) : in_(in),
+															 p_(p),
+															 sampled_(in.samplingstep()) {
+					if (sampled_) start_ = clock::now();
+				}
+				~sampledtimer() {
+					if (sampled_) in_.addtime(p_, clock::now() - start_);
+				}
+
+				sampledtimer(const sampledtimer&) = delete;
+				sampledtimer& operator=(const sampledtimer&) = delete;
+
+			private:
+				instrumentation& in_;
+				const phase p_;
+				const bool sampled_;
+				clock::time_point start_;
+		};
+
+	private:
+		struct steprecord {
+			clock::time_point start;
+			bool sampled = false;	// sampled phases timed in this step
+			std::array<long, numcounters> counters{};
+			std::array<clock::duration, numphases> times{};
+		};
+
+		struct traceevent {
+			phase p;
+			clock::time_point start;
+			clock::duration dur;
+		};
+
+		// microseconds since construction, the unit of Chrome traces
+		double us_(clock::time_point t) const {
+			return std::chrono::duration<double, std::micro>(t - t0_).count();
+		}
+
+		const clock::time_point t0_;
+		std::vector<steprecord> steps_;
+		std::vector<traceevent> events_;
+		unsigned long droppedevents_ = 0;	// trace events beyond maxevents
+		std::array<unsigned long, numbins> hist_{};
+};
+
+extern instrumentation instr; // defined in instrument.cpp
+
+#define GROWTH_CONCAT_(a, b) a##b
+#define GROWTH_CONCAT(a, b) GROWTH_CONCAT_(a, b)
+
+#ifdef GROWTH_INSTRUMENT
+// time the rest of the enclosing scope, with (TRACE) or without (TIME) a trace event
+#define GROWTH_TRACE(p) instrumentation::scopedtimer GROWTH_CONCAT(growthtimer_, __LINE__)(instr, phase::p, true)
+#define GROWTH_TIME(p) instrumentation::scopedtimer GROWTH_CONCAT(growthtimer_, __LINE__)(instr, phase::p, false)
+// like GROWTH_TIME for per-Cell scopes: only times during one in samplesteps steps
+#define GROWTH_SAMPLE(p) instrumentation::sampledtimer GROWTH_CONCAT(growthtimer_, __LINE__)(instr, phase::p)
+#define GROWTH_COUNT(c, n) instr.add(counter::c, (n))
+#define GROWTH_SET(c, n) instr.set(counter::c, (n))
+#define GROWTH_SUMPOT(v) instr.sample(v)
+#define GROWTH_STEP() instr.beginstep()
+#define GROWTH_EXPORT(trace, csv, hist) instr.exportall((trace), (csv), (hist))
+#else
+#define GROWTH_TRACE(p) ((void)0)
+#define GROWTH_TIME(p) ((void)0)
+#define GROWTH_SAMPLE(p) ((void)0)
+#define GROWTH_COUNT(c, n) ((void)0)
+#define GROWTH_SET(c, n) ((void)0)
+#define GROWTH_SUMPOT(v) ((void)0)
+#define GROWTH_STEP() ((void)0)
+#define GROWTH_EXPORT(trace, csv, hist) (true) // nothing to write, so nothing can fail
+#endif
@@ -18,73 +18,63 @@ void ofApp::setup(){
     fbo_.begin();
     ofClear(0);
     
+    // potentialfunc values before any cell spawned, to view for debugging purposes
+    params.dumppotential("../src/pfuncvals.csv");
+
     // Get initial cells
-    for (auto coord : initcellcoords_) {
-        cell_shrptr newcell(new Cell(coord));
-        activecells_.push_back(newcell);
-    }
+    sim_.reset(new simulation(params));
+    drawnewcells_();
     fbo_.end();
 }
 
 //--------------------------------------------------------------
 void ofApp::update(){
+    if (!running_) return;
+
     fbo_.begin();
     for (int s = 0; s < stride_; s++) {
-        ofLogNotice() << "# of active cells: " << activecells_.size();
-
-        // Output Potential values for debugging purposes
-        // if (activecells_.size() == 0) {
-        //     std::ofstream os("../src/pfuncvalsend.csv");
-        //     for (int j = 0; j < potentialmap_.sizey(); j++) {
-		// 		for (int i = 0; i < potentialmap_.sizex(); i++) {
-		// 			os << potentialmap_(i, j).second << ",";
-		// 		}
-		// 		os << "\n";
-		// 	}
-        //     ofExit();
-        // }
-        
-        // Erase cells that cannot multiply
-        // (i.e. 0 surr. potential, typically because all neighbor pixels occupied)
-        unsigned cnt = 0;
-        unsigned sizepre = activecells_.size();
-        activecells_.erase(std::remove_if(activecells_.begin(),
-                                        activecells_.end(),
-                                        [&cnt](cell_shrptr c) {
-                                                bool b = !c->canmultiply();
-                                                if (b) cnt++;
-                                                return b;
-                                        }
-                                        ),
-                        activecells_.end()
-        );
-
-        if (activecells_.size() == 0) {
-            fbo_.end();
-            return;
-        }
-
-        if (activecells_.size() + cnt != sizepre) {
-            throw std::runtime_error("Counted more dead Cells than were deleted!");
-        }
-
-
-        // Multiply Cells with highest potential
-        std::vector<cell_shrptr> newcells;
-        std::sort(activecells_.begin(), activecells_.end(), cellptrless_);
-        int cursizered = std::min((unsigned)activecells_.size(), (unsigned)activecells_.size()/2u + 1);
-        for (int i = 0; i < cursizered; i++) {
-            ofLogNotice() << "multiplying cell " << i+1;
-            cell_shrptr newcell = activecells_[i]->multiply();
-            activecells_.push_back(newcell);
+        if (!sim_->step()) {
+            running_ = false;
+            // Output Potential values for debugging purposes
+            // params.dumppotential("../src/pfuncvalsend.csv");
+            // ofExit();
+            break;
         }
+        drawnewcells_();
     }
     fbo_.end();
 }
 
+//--------------------------------------------------------------
+void ofApp::drawnewcells_(){
+    GROWTH_TIME(draw);
+    for (const auto& ij : sim_->newcells()) {
+        ofDrawRectangle(ij.first*pixelsize_, ij.second*pixelsize_,
+                        pixelsize_, pixelsize_
+        ); // pixelsize mult. translates from standard Cell grid [0, gridsizex] x [0, gridsizey] to
+           // what OF uses: [0, windowwidth] x [0, windowheight]
+    }
+}
+
 //--------------------------------------------------------------
 void ofApp::draw(){
-    fbo_.draw(0, 0, windowwidth_, windowheight_);
+    // only measured while growing, afterwards every frame shows the same fbo
+    if (running_) {
+        GROWTH_TRACE(draw);
+        fbo_.draw(0, 0, windowwidth_, windowheight_);
+    } else {
+        fbo_.draw(0, 0, windowwidth_, windowheight_);
+    }
+}
+
+//--------------------------------------------------------------
+void ofApp::exit(){
+    // write instrumentation results (no-op unless built with GROWTH_INSTRUMENT)
+    if (!GROWTH_EXPORT(ofToDataPath("growth_trace.json"),
+                       ofToDataPath("growth_steps.csv"),
+                       ofToDataPath("growth_sumpot_hist.csv"))) {
+        ofLogError("ofApp::exit") << "could not write instrumentation results to " << ofToDataPath("");
+    }
 }
 
 //--------------------------------------------------------------
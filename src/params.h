@@ -1,12 +1,33 @@
 #pragma once
 #include <exception>
-#include "ofMain.h"
+#include <stdexcept>
 #include <vector>
 #include <fstream>
+#include <random>
+#include <string>
+#include "growth.h"
 /*
  * This File defines all runtime parameters & objects that need to accessed by all cells (global)
+ * Does not depend on openFrameworks so it can be built into the headless library (see growth.h)
  */
 
+/*
+ * Minimal 2D float vector for coordinates, only provides what the parameters need
+ * (componentwise arithmetic like ofVec2f)
+ */
+struct vec2f {
+	float x = 0.f;
+	float y = 0.f;
+
+	vec2f() = default;
+	vec2f(float x_, float y_) : x(x_), y(y_) {}
+
+	vec2f operator+(const vec2f& o) const { return {x + o.x, y + o.y}; }
+	vec2f operator-(const vec2f& o) const { return {x - o.x, y - o.y}; }
+	vec2f operator*(const vec2f& o) const { return {x * o.x, y * o.y}; }
+	vec2f operator/(const vec2f& o) const { return {x / o.x, y / o.y}; }
+};
+
 /* Simple Wrapper Class for dynamic float arrays of 2 dimensions
  * that has a buffer: accesses which are out of range by bufsize return buf
  * Not Copyable
@@ -60,20 +81,31 @@ class edgebufArr {
 		}
 
 		// Return size of 1st dimension of array
-		int sizex() {
+		int sizex() const {
 			return sizex_ - 2 * bufsize_;
 		}
 
 		// Return size of 2nd dimension of array
-		int sizey() {
+		int sizey() const {
 			return sizey_ - 2 * bufsize_;
 		}
 		
 		// Return total size
-		int size() {
+		int size() const {
 			return sizex() * sizey();
 		}
 
+		// Raw read-only access to the element at (0, 0), for zero-copy views.
+		// Element (i, j) sits at data()[i*stride() + j] (also for the buffer, i.e. i, j in [-bufsize, size + bufsize))
+		const T* data() const {
+			return arr_ + bufsize_*sizey_ + bufsize_;
+		}
+
+		// Distance in elements between (i, j) and (i+1, j)
+		int stride() const {
+			return sizey_;
+		}
+
 	private:
 		T* arr_;			 // Underlying array
 		const int sizex_;	 // size in first dim (incl. buffer!)
@@ -191,48 +223,48 @@ class circleindices {
  */
 class parameters {
 	public:
-		parameters() : initcellcoords(numinitcells),
-					   cind(circleindices(2, celldeterrad).indices),
-					   potentialmap(gridsizex, gridsizey, celldeterrad, 0.f) { // is an edgebufArr so needs a calue to fill buffer
-			if ((windowwidth % pixelsize != 0)
-				|| (windowheight % pixelsize != 0)) {
-				throw std::runtime_error(
-					"params.h:pixelsize does not divide window into homogenous grid"
-				);
-			}
+		// Uses the values set below (defaultsettings())
+		parameters() : parameters(defaultsettings()) {}
 
+		// Overrides the values set below (used by the library, see growth.h)
+		parameters(const growth_params& p) : windowwidth(p.windowwidth),
+											 windowheight(p.windowheight),
+											 pixelsize(p.pixelsize),
+											 numinitcells(p.numinitcells),
+											 celldeterrad(p.celldeterrad),
+											 cellattractrad(p.cellattractrad),
+											 celldeterage(p.celldeterage),
+											 celldeterfactor(p.celldeterfactor),
+											 cellattractfactor(p.cellattractfactor),
+											 seed(p.seed),
+											 initcellcoords(numinitcells),
+											 cind(circleindices(2, celldeterrad).indices),
+											 potentialmap(gridsizex, gridsizey, celldeterrad, 0.f), // is an edgebufArr so needs a calue to fill buffer
+											 occupancy(gridsizex, gridsizey, 0, 0) {
+			init_();
+		}
 
-			// Set up potentialmap to carry coordinate grid and potentials of cells
-			std::ofstream pfuncvals("../src/pfuncvals.csv"); // to view for debugging purposes
-			ofVec2f coord(0., 0.);
+		// Write the current potentialmap as csv (to view for debugging purposes)
+		void dumppotential(const std::string& path) const {
+			std::ofstream pfuncvals(path);
 			for (int i = 0; i < gridsizex; i++) {
-				coord.y = 0.;
 				for (int j = 0; j < gridsizey; j++) {
-					// Translate the vec as potential func should be defined on [-1, 1]^2
-					ofVec2f translated = maptocoordsys(coord);
-					float pval = potentialfunc(translated);
-					if (pval < 0.) throw  std::runtime_error("potentialfunc gave a negative value!");
-					potentialmap(i, j) = pval;
-					pfuncvals << pval << ",";
-					coord.y += 1;
+					pfuncvals << potentialmap(i, j) << ",";
 				}
 				pfuncvals << "\n";
-				coord.x += 1;
 			}
-
-			initcells();
 		}
 
 		// Maps vectors from [0, gridsizex] x [0, gridsizey] to [-1, 1]^2 
-		ofVec2f maptocoordsys(ofVec2f coord) {
-			return (coord - ofVec2f(0.5*(gridsizex-1), 0.5*(gridsizey-1)))
-					/ ofVec2f(0.5*(gridsizex-1), -0.5*(gridsizey-1));
+		vec2f maptocoordsys(vec2f coord) {
+			return (coord - vec2f(0.5*(gridsizex-1), 0.5*(gridsizey-1)))
+					/ vec2f(0.5*(gridsizex-1), -0.5*(gridsizey-1));
 		}
 
 		// Maps vectors from [-1, 1]^2 to [0, gridsizex] x [0, gridsizey]
-		ofVec2f maptogrid(ofVec2f coord) {
-			return coord * ofVec2f(0.5*(gridsizex-1), -0.5*(gridsizey-1))
-				   + ofVec2f(0.5*(gridsizex-1), 0.5*(gridsizey));
+		vec2f maptogrid(vec2f coord) {
+			return coord * vec2f(0.5*(gridsizex-1), -0.5*(gridsizey-1))
+				   + vec2f(0.5*(gridsizex-1), 0.5*(gridsizey));
 		}
 
 		// RUNTIME PARAMETERS
@@ -240,25 +272,45 @@ class parameters {
 
 		// Potential Function for potentialmap,
 		// should be STRICTLY POSITIVE and DEFINED ON [-1, 1]^2
-		float potentialfunc(ofVec2f& pos) {
+		float potentialfunc(vec2f& pos) {
 			return 0.5*(pos.y + 1.);
 		}
 
-		const int windowwidth = 800;	   	 // in pixels
-		const int windowheight = 800;	   	 // in pixels
-		const int pixelsize = 4; 		   	 // size of cell in pixels
-		const int numinitcells = 1; 	   	 // inital number of cells, should match
-		const int stride = 1; 			   	 // how many multiplications per frame, adjusts speed
-		const int celldeterrad = 10; 	   	 // radius in which a cell diminishes potential >= 2 if it should exist
-		const int cellattractrad = 2; 	   	 // radius in which a cell increases potential >= 2 if it should exist
-		const int celldeterage = 3;			 // age at which cell diminishes farther potential
-		const float celldeterfactor = 0.9; 	 // the smaller, the more a cell of age celldeterage
+		// Cheap to call (no allocation), also used by growth_defaultparams()
+		static growth_params defaultsettings() {
+			growth_params p;
+			p.size = sizeof(growth_params);
+			p.windowwidth = 800;	   	 	 // in pixels
+			p.windowheight = 800;	   	 	 // in pixels
+			p.pixelsize = 4; 		   	 	 // size of cell in pixels
+			p.numinitcells = 1; 	   	 	 // inital number of cells, should match
+			p.celldeterrad = 10; 	   	 	 // radius in which a cell diminishes potential >= 2 if it should exist
+			p.cellattractrad = 2; 	   	 	 // radius in which a cell increases potential >= 2 if it should exist
+			p.celldeterage = 3;			 	 // age at which cell diminishes farther potential
+			p.celldeterfactor = 0.9; 	 	 // the smaller, the more a cell of age celldeterage
 										   	 // will try and keep cells of distance [2, celldeterrad]
 										   	 // away, should be in  [0, 1]
-		const float cellattractfactor = 10.; // Same as celldeterfactor only increases potential instead (at creation)
+			p.cellattractfactor = 10.; 	 	 // Same as celldeterfactor only increases potential instead (at creation)
 											 // should be larger (or equal if no attraction) than 1
+			p.seed = std::random_device{}(); // seed for rng, set to a fixed value for reproducible runs
+			return p;
+		}
+
+		const int stride = 1; 			   	 // how many multiplications per frame, adjusts speed (app only)
 
-		std::vector<ofVec2f> initcellcoords; // Set Contents here:
+		// Set from defaultsettings() or growth_params (see above)
+		const int windowwidth;
+		const int windowheight;
+		const int pixelsize;
+		const int numinitcells;
+		const int celldeterrad;
+		const int cellattractrad;
+		const int celldeterage;
+		const float celldeterfactor;
+		const float cellattractfactor;
+		const unsigned seed;
+
+		std::vector<vec2f> initcellcoords; // Set Contents here:
 		inline void initcells() {
 		// Define set of first cells
 			// Note that here coordinates are in 
@@ -280,4 +332,40 @@ class parameters {
 			std::vector<std::pair<int, int>>
 		> cind;										  		// Relevant indices for pixelated circle
 		edgebufArr<float> potentialmap; 					// Stores potential on Grid [0, gridsizex] x [0, gridsizey]
+		edgebufArr<unsigned char> occupancy;				// 1 where a Cell sits on Grid [0, gridsizex] x [0, gridsizey], else 0
+		std::mt19937 rng{seed};								// used by Cells to choose where to multiply
+
+	private:
+		// Checks parameters, sets up potentialmap and initial cell coordinates
+		void init_() {
+			if (pixelsize <= 0
+				|| (windowwidth % pixelsize != 0)
+				|| (windowheight % pixelsize != 0)) {
+				throw std::runtime_error(
+					"params.h:pixelsize does not divide window into homogenous grid"
+				);
+			}
+			if (cellattractrad > celldeterrad) {
+				throw std::runtime_error(
+					"params.h:cellattractrad must not be larger than celldeterrad"
+				);
+			}
+
+			// Set up potentialmap to carry coordinate grid and potentials of cells
+			vec2f coord(0., 0.);
+			for (int i = 0; i < gridsizex; i++) {
+				coord.y = 0.;
+				for (int j = 0; j < gridsizey; j++) {
+					// Translate the vec as potential func should be defined on [-1, 1]^2
+					vec2f translated = maptocoordsys(coord);
+					float pval = potentialfunc(translated);
+					if (pval < 0.) throw  std::runtime_error("potentialfunc gave a negative value!");
+					potentialmap(i, j) = pval;
+					coord.y += 1;
+				}
+				coord.x += 1;
+			}
+
+			initcells();
+		}
 };
\ No newline at end of file
@@ -0,0 +1,78 @@
+#include "simulation.h"
+
+//--------------------------------------------------------------
+simulation::simulation(parameters& params) : params_(params) {
+    // Get initial cells
+    for (auto coord : params_.initcellcoords) {
+        cell_shrptr newcell(new Cell(params_, coord));
+        activecells_.push_back(newcell);
+        newcells_.push_back({newcell->geti(), newcell->getj()});
+    }
+    totalcells_ = activecells_.size();
+}
+
+//--------------------------------------------------------------
+bool simulation::step(){
+    // nothing left to do (and nothing worth recording)
+    if (activecells_.size() == 0) {
+        newcells_.clear();
+        lastspawned_ = 0;
+        lastculled_ = 0;
+        return false;
+    }
+
+    GROWTH_STEP();
+    GROWTH_SET(activecells, activecells_.size());
+    newcells_.clear();
+    lastspawned_ = 0;
+
+    // Erase cells that cannot multiply
+    // (i.e. 0 surr. potential, typically because all neighbor pixels occupied)
+    unsigned cnt = 0;
+    unsigned sizepre = activecells_.size();
+    {
+        GROWTH_TRACE(culling);
+        activecells_.erase(std::remove_if(activecells_.begin(),
+                                        activecells_.end(),
+                                        [&cnt](cell_shrptr c) {
+                                                bool b = !c->canmultiply();
+                                                if (b) cnt++;
+                                                return b;
+                                        }
+                                        ),
+                        activecells_.end()
+        );
+    }
+    GROWTH_COUNT(culled, cnt);
+    lastculled_ = cnt;
+
+    if (activecells_.size() == 0) {
+        return false;
+    }
+
+    if (activecells_.size() + cnt != sizepre) {
+        throw std::runtime_error("Counted more dead Cells than were deleted!");
+    }
+
+
+    // Multiply Cells with highest potential
+    {
+        GROWTH_TRACE(selection);
+        std::sort(activecells_.begin(), activecells_.end(), cellptrless_);
+    }
+    int cursizered = std::min((unsigned)activecells_.size(), (unsigned)activecells_.size()/2u + 1);
+    {
+        GROWTH_TRACE(multiply);
+        for (int i = 0; i < cursizered; i++) {
+            cell_shrptr newcell = activecells_[i]->multiply();
+            activecells_.push_back(newcell);
+            newcells_.push_back({newcell->geti(), newcell->getj()});
+        }
+    }
+    GROWTH_COUNT(spawns, cursizered);
+
+    lastspawned_ = cursizered;
+    totalcells_ += cursizered;
+    step_++;
+    return true;
+}